@@ -0,0 +1,174 @@
+/*
+
+MIT License
+
+Copyright (c) 2018 Matteo Ugolotti
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "collections.hpp"
+
+namespace fp
+{
+
+// Builds a collection from many threads concurrently.
+// Each thread appends to its own producer, which buffers elements locally and
+// publishes them to the builder without locks when flushed or destroyed.
+// The order of the elements of different producers is unspecified.
+template <typename T>
+class collection_builder
+{
+  private:
+    // A buffer published by a producer
+    struct segment
+    {
+      std::vector<T> values;
+      segment* next;
+    };
+
+    std::atomic<segment*> _segments;
+
+    void publish(std::vector<T>&& values) {
+      auto s = new segment{std::move(values), _segments.load(std::memory_order_relaxed)};
+      while (!_segments.compare_exchange_weak(s->next, s,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+      }
+    }
+
+  public:
+    // Appends elements on behalf of a single thread
+    class producer
+    {
+      private:
+        collection_builder<T>* _builder;
+        std::vector<T> _values;
+
+      public:
+        producer(collection_builder<T>& builder) :
+          _builder{&builder},
+          _values{} {
+        }
+
+        producer(producer&& other) :
+          _builder{other._builder},
+          _values{std::move(other._values)} {
+          other._values.clear();
+        }
+
+        producer(producer const&) = delete;
+        producer& operator=(producer const&) = delete;
+        producer& operator=(producer&&) = delete;
+
+        ~producer() {
+          flush();
+        }
+
+        // Appends an element to the local buffer
+        void append(T value) {
+          _values.push_back(std::move(value));
+        }
+
+        // Publishes the buffered elements to the builder
+        void flush() {
+          if (!_values.empty()) {
+            _builder->publish(std::move(_values));
+            _values = std::vector<T>{};
+          }
+        }
+    };
+
+    collection_builder<T>() :
+      _segments{nullptr} {
+    }
+
+    collection_builder<T>(collection_builder<T> const&) = delete;
+    collection_builder<T>& operator=(collection_builder<T> const&) = delete;
+
+    ~collection_builder<T>() {
+      auto s = _segments.exchange(nullptr);
+      while (s) {
+        delete std::exchange(s, s->next);
+      }
+    }
+
+    // Returns a new producer, to be used by a single thread
+    producer make_producer() {
+      return producer{*this};
+    }
+
+    // Returns a collection of all the elements published so far and empties the builder.
+    // Producers still in use must be flushed or destroyed first.
+    // When a single producer published elements they are moved into the collection
+    collection<T> build();
+};
+
+template <typename T>
+collection<T> collection_builder<T>::build()
+{
+  auto s = _segments.exchange(nullptr, std::memory_order_acquire);
+
+  // Segments are pushed on a stack, reverse it to read them in publishing order,
+  // which keeps the elements of each producer in order
+  segment* reversed = nullptr;
+  while (s) {
+    auto next = std::exchange(s->next, reversed);
+    reversed = s;
+    s = next;
+  }
+  s = reversed;
+
+  if (!s) {
+    return collection<T>{};
+  }
+
+  if (!s->next) {
+    collection<T> result{std::move(s->values)};
+    delete s;
+    return result;
+  }
+
+  std::size_t size = 0;
+  for (auto it = s; it; it = it->next) {
+    size += it->values.size();
+  }
+
+  std::vector<T> values;
+  values.reserve(size);
+
+  while (s) {
+    values.insert(values.end(),
+                  std::make_move_iterator(s->values.begin()),
+                  std::make_move_iterator(s->values.end()));
+    delete std::exchange(s, s->next);
+  }
+
+  return collection<T>{std::move(values)};
+}
+
+}
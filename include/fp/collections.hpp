@@ -27,19 +27,30 @@ SOFTWARE.
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <list>
+#include <optional>
+#include <stdexcept>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "execution.hpp"
+#include "sketches.hpp"
+
 namespace fp
 {
 
-// Maximum number of threads for concurrent functions
-static const int kMaxThreads = 4;
+class writer;
+
+// nth according to an execution policy selects with top_k only when the selected
+// elements are at most 1 / kMaxSelectFraction of the collection, since the partial
+// results of the chunks are merged on a single thread
+static const std::size_t kMaxSelectFraction = 64;
 
 // A collection of objects supporting functional patterns
 template <typename T>
@@ -48,6 +59,22 @@ class collection
   private:
     std::vector<T> _values;
 
+    template <typename U>
+    friend class collection;
+
+    friend class writer;
+
+    // Adds each chunk of the collection to a copy of the given empty sketch
+    // according to the execution policy, then merges the partial sketches
+    template <typename Sketch, typename Policy>
+    Sketch psketch(Sketch const& empty, Policy const& policy) const;
+
+    // Moves the partial results of the chunks, in order, into a single vector.
+    // Chunks build their own partial results instead of writing to a shared vector,
+    // since neighbouring elements of a std::vector<bool> share the same word
+    template <typename U>
+    static std::vector<U> concat_partials(std::vector<std::vector<U>>& partials);
+
   public:
     // Constructor for epty collection
     collection<T>() :
@@ -76,6 +103,11 @@ class collection
 	  _values{v} {
 	}
 
+	// Vector constructor, taking ownership of the elements without copying them
+	collection<T>(std::vector<T>&& v) :
+	  _values{std::move(v)} {
+	}
+
 	// List constructor
 	collection<T>(std::list<T> const& v) :
 	  _values{v.begin(), v.end()} {
@@ -110,11 +142,10 @@ class collection
 	friend std::ostream &operator<<(std::ostream &stream, collection<T> const& f) {
 	  stream << "[";
 
-	  for (int i = 0; i < f._values.size() - 1; i++) {
-	    stream << f._values[i] << ",";
+	  for (int i = 0; i < f._values.size(); i++) {
+	    stream << (i > 0 ? "," : "") << f._values[i];
 	  }
 
-	  stream << f._values[f._values.size() - 1];
 	  stream << "]";
 
 	  return stream;
@@ -133,18 +164,116 @@ class collection
 	// Applies a function to each element of the collection
 	void each(std::function<void(T)> f);
 
+	// Applies a function to each element of the collection according to the execution policy
+	template <typename Policy>
+	enable_if_policy<Policy> each(Policy const& policy, std::function<void(T)> f) const;
+
 	// Returns a subset of the collection, filtered by the given predicate
 	collection<T> filter(std::function<bool(T)> f) const;
 
+	// Returns a subset of the collection, filtered by the given predicate
+	// according to the execution policy
+	template <typename Policy>
+	enable_if_policy<Policy, collection<T>> filter(Policy const& policy, std::function<bool(T)> f) const;
+
 	// Returns the [begin, end) subset of the collection
 	collection<T> slice(int begin, int end) const;
 
 	// Returns the number of elements for which the given predicate evaluates to true
 	int count(std::function<bool(T)> f) const;
 
+	// Returns the number of elements for which the given predicate evaluates to true
+	// according to the execution policy
+	template <typename Policy>
+	enable_if_policy<Policy, int> count(Policy const& policy, std::function<bool(T)> f) const;
+
+	// Returns the first element for which the given predicate evaluates to true,
+	// stopping at the first match
+	std::optional<T> find(std::function<bool(T)> f) const;
+
+	// A concurrent implementation of find, chunks past an already found match are abandoned
+	std::optional<T> pfind(std::function<bool(T)> f,
+	                       const unsigned long threads = kMaxThreads) const;
+
+	// find according to the execution policy, chunks past an already found match are abandoned
+	template <typename Policy>
+	enable_if_policy<Policy, std::optional<T>> find(Policy const& policy, std::function<bool(T)> f) const;
+
+	// Returns true if the given predicate evaluates to true for at least one element
+	bool any(std::function<bool(T)> f) const;
+
+	// Returns true if the given predicate evaluates to true for all elements
+	bool all(std::function<bool(T)> f) const;
+
+	// Returns true if the given predicate evaluates to false for all elements
+	bool none(std::function<bool(T)> f) const;
+
+	// Concurrent implementations of any, all and none, all threads stop
+	// as soon as one of them finds a result
+	bool pany(std::function<bool(T)> f, const unsigned long threads = kMaxThreads) const;
+	bool pall(std::function<bool(T)> f, const unsigned long threads = kMaxThreads) const;
+	bool pnone(std::function<bool(T)> f, const unsigned long threads = kMaxThreads) const;
+
+	// any, all and none according to the execution policy, all chunks stop
+	// as soon as one of them finds a result
+	template <typename Policy>
+	enable_if_policy<Policy, bool> any(Policy const& policy, std::function<bool(T)> f) const;
+	template <typename Policy>
+	enable_if_policy<Policy, bool> all(Policy const& policy, std::function<bool(T)> f) const;
+	template <typename Policy>
+	enable_if_policy<Policy, bool> none(Policy const& policy, std::function<bool(T)> f) const;
+
+	// Returns the longest prefix of the collection for which the given predicate evaluates to true
+	collection<T> take_while(std::function<bool(T)> f) const;
+
+	// Returns the collection without the longest prefix for which the given predicate
+	// evaluates to true
+	collection<T> drop_while(std::function<bool(T)> f) const;
+
 	// Returns a copy of the Collection, sorted according to the given predicate
 	collection<T> sort(std::function<bool(T, T)> f) const;
 
+	// Returns a sorted copy of the Collection according to the execution policy,
+	// chunks are sorted independently and then merged
+	template <typename Policy>
+	enable_if_policy<Policy, collection<T>> sort(Policy const& policy, std::function<bool(T, T)> f) const;
+
+	// Returns the first k elements of the collection, sorted according to the given predicate
+	// Runs in O(n log k) without sorting the whole collection
+	collection<T> top_k(int k, std::function<bool(T, T)> f) const;
+
+	// A concurrent implementation of top_k, each thread selects the top k
+	// elements of its chunk and the partial results are merged
+	collection<T> ptop_k(int k, std::function<bool(T, T)> f,
+	                     const unsigned long threads = kMaxThreads) const;
+
+	// top_k according to the execution policy, the top k elements of each chunk are merged
+	template <typename Policy>
+	enable_if_policy<Policy, collection<T>> top_k(Policy const& policy, int k,
+	                                              std::function<bool(T, T)> f) const;
+
+	// Returns a copy of the Collection where the first k elements are sorted according
+	// to the given predicate, the order of the remaining elements is unspecified
+	collection<T> partial_sort(int k, std::function<bool(T, T)> f) const;
+
+	// partial_sort according to the execution policy, each chunk is partially sorted
+	// and the first k elements are selected among the heads of the chunks
+	template <typename Policy>
+	enable_if_policy<Policy, collection<T>> partial_sort(Policy const& policy, int k,
+	                                                     std::function<bool(T, T)> f) const;
+
+	// Returns the element at position k if the collection was sorted according
+	// to the given predicate
+	// Throws if k is out of range
+	T nth(int k, std::function<bool(T, T)> f) const;
+
+	// nth according to the execution policy, selects the top k + 1 elements,
+	// or the bottom size - k ones if fewer, with top_k. Closer to the middle of the
+	// collection, as set by kMaxSelectFraction, it falls back to the serial nth
+	// Throws if k is out of range
+	template <typename Policy>
+	enable_if_policy<Policy, T> nth(Policy const& policy, int k, std::function<bool(T, T)> f) const;
+
 	// Returns a new collection, as the result of the application of the given function
 	// to each element of the initial collection
 	template <typename Func>
@@ -156,11 +285,21 @@ class collection
 	collection<typename std::result_of<Function(T)>::type>
 	pmap(Function func, const unsigned long threads = kMaxThreads) const;
 
+	// map according to the execution policy
+	template <typename Policy, typename Function>
+	enable_if_policy<Policy, collection<typename std::result_of<Function(T)>::type>>
+	map(Policy const& policy, Function f) const;
+
 	// Returns the result of the application of the binary operator on the Collection
 	// starting from the first element
 	// Throws if the collection is empty
 	T reduce(std::function<T(T, T)> f) const;
 
+	// reduce according to the execution policy, the binary operator must be associative
+	// Throws if the collection is empty
+	template <typename Policy>
+	enable_if_policy<Policy, T> reduce(Policy const& policy, std::function<T(T, T)> f) const;
+
 	// Returns the result of the application of the binary operator on the Collection
 	// starting from the last element
 	// Throws if the Collection is empty
@@ -183,6 +322,72 @@ class collection
 	foldr(Function f, I init) const;
 
   collection<T> concat(const collection<T>&) const;
+
+	// Returns the running results of the application of the binary operator on the
+	// Collection, starting from the first element (inclusive prefix scan)
+	collection<T> scan(std::function<T(T, T)> f) const;
+
+	// A concurrent implementation of scan, the binary operator must be associative
+	collection<T> pscan(std::function<T(T, T)> f,
+	                    const unsigned long threads = kMaxThreads) const;
+
+	// scan according to the execution policy, the binary operator must be associative
+	template <typename Policy>
+	enable_if_policy<Policy, collection<T>> scan(Policy const& policy, std::function<T(T, T)> f) const;
+
+	// Returns the running results of fold, starting from the given initial value
+	// and the first element. The result has one element more than the Collection
+	template <typename Function, typename I>
+	collection<typename std::result_of<Function(I, T)>::type>
+	scanl(Function f, I init) const;
+
+	// Returns the running results of foldr, starting from the given initial value
+	// and the last element. The result has one element more than the Collection,
+	// the initial value being the last one
+	template <typename Function, typename I>
+	collection<typename std::result_of<Function(I, T)>::type>
+	scanr(Function f, I init) const;
+
+	// Returns an estimate of the number of distinct elements, using a HyperLogLog
+	// sketch of bounded size computed concurrently on chunks of the collection
+	double approx_distinct(const unsigned long threads = kMaxThreads) const;
+
+	// Returns an estimate of the element whose rank is q times the size of the collection,
+	// using KLL sketches computed concurrently on chunks of the collection
+	// Throws if the collection is empty
+	T approx_quantile(double q, const unsigned long threads = kMaxThreads) const;
+
+	// Returns a count-min sketch of the collection, computed concurrently on chunks
+	// of the collection, which estimates the frequency of any element
+	count_min_sketch<T> approx_frequency(const unsigned long threads = kMaxThreads) const;
+
+	// Sketch based terminal operations according to the execution policy
+	template <typename Policy>
+	enable_if_policy<Policy, double> approx_distinct(Policy const& policy) const;
+	template <typename Policy>
+	enable_if_policy<Policy, T> approx_quantile(Policy const& policy, double q) const;
+	template <typename Policy>
+	enable_if_policy<Policy, count_min_sketch<T>> approx_frequency(Policy const& policy) const;
+
+	// Returns the collection of pairs of elements at the same position in both collections,
+	// as long as the shortest one
+	template <typename U>
+	collection<std::pair<T, U>> zip(collection<U> const& other) const;
+
+	// zip according to the execution policy
+	template <typename Policy, typename U>
+	enable_if_policy<Policy, collection<std::pair<T, U>>> zip(Policy const& policy, collection<U> const& other) const;
+
+	// Returns the result of the application of the given function to the elements
+	// at the same position in both collections, as long as the shortest one
+	template <typename U, typename Function>
+	collection<typename std::result_of<Function(T, U)>::type>
+	zip_with(collection<U> const& other, Function f) const;
+
+	// zip_with according to the execution policy
+	template <typename Policy, typename U, typename Function>
+	enable_if_policy<Policy, collection<typename std::result_of<Function(T, U)>::type>>
+	zip_with(Policy const& policy, collection<U> const& other, Function f) const;
 };
 
 template <typename T>
@@ -213,6 +418,18 @@ void collection<T>::each(std::function<void(T)> f)
   }
 }
 
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy> collection<T>::each(Policy const& policy, std::function<void(T)> f) const
+{
+  execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      f(_values[i]);
+    }
+    return end - begin;
+  });
+}
+
 template <typename T>
 collection<T> collection<T>::filter(std::function<bool(T)> f) const
 {
@@ -226,6 +443,24 @@ collection<T> collection<T>::filter(std::function<bool(T)> f) const
   return collection<T>{values};
 }
 
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, collection<T>>
+collection<T>::filter(Policy const& policy, std::function<bool(T)> f) const
+{
+  auto partials = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<T> values;
+    for (auto i = begin; i < end; ++i) {
+      if (f(_values[i])) {
+        values.push_back(_values[i]);
+      }
+    }
+    return values;
+  });
+
+  return collection<T>{concat_partials(partials)};
+}
+
 template <typename T>
 collection<T> collection<T>::slice(int begin, int end) const
 {
@@ -252,6 +487,137 @@ int collection<T>::count(std::function<bool(T)> f) const {
   return count;
 }
 
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, int> collection<T>::count(Policy const& policy, std::function<bool(T)> f) const {
+  const auto partials = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    int count {0};
+    for (auto i = begin; i < end; ++i) {
+      if (f(_values[i])) {
+        ++count;
+      }
+    }
+    return count;
+  });
+
+  int count {0};
+  for (const auto partial : partials) {
+    count += partial;
+  }
+
+  return count;
+}
+
+template <typename T>
+std::optional<T> collection<T>::find(std::function<bool(T)> f) const {
+  const auto it = std::find_if(_values.begin(), _values.end(), f);
+
+  return (it != _values.end()) ? std::optional<T>{*it}
+                               : std::nullopt;
+}
+
+template <typename T>
+std::optional<T> collection<T>::pfind(std::function<bool(T)> f,
+                                       const unsigned long threads) const {
+  return find(parallel_policy{threads}, f);
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, std::optional<T>>
+collection<T>::find(Policy const& policy, std::function<bool(T)> f) const {
+  std::atomic<std::size_t> found{_values.size()};
+
+  execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    // Stop as soon as an earlier match has been found by any chunk
+    for (auto i = begin; i < end && i < found.load(std::memory_order_relaxed); ++i) {
+      if (f(_values[i])) {
+        auto current = found.load();
+        while (i < current && !found.compare_exchange_weak(current, i)) {
+        }
+        return i;
+      }
+    }
+    return end;
+  });
+
+  return (found < _values.size()) ? std::optional<T>{_values[found]}
+                                  : std::nullopt;
+}
+
+template <typename T>
+bool collection<T>::any(std::function<bool(T)> f) const {
+  return std::any_of(_values.begin(), _values.end(), f);
+}
+
+template <typename T>
+bool collection<T>::all(std::function<bool(T)> f) const {
+  return std::all_of(_values.begin(), _values.end(), f);
+}
+
+template <typename T>
+bool collection<T>::none(std::function<bool(T)> f) const {
+  return std::none_of(_values.begin(), _values.end(), f);
+}
+
+template <typename T>
+bool collection<T>::pany(std::function<bool(T)> f, const unsigned long threads) const {
+  return any(parallel_policy{threads}, f);
+}
+
+template <typename T>
+bool collection<T>::pall(std::function<bool(T)> f, const unsigned long threads) const {
+  return all(parallel_policy{threads}, f);
+}
+
+template <typename T>
+bool collection<T>::pnone(std::function<bool(T)> f, const unsigned long threads) const {
+  return none(parallel_policy{threads}, f);
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, bool> collection<T>::any(Policy const& policy, std::function<bool(T)> f) const {
+  std::atomic<bool> found{false};
+
+  execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end && !found.load(std::memory_order_relaxed); ++i) {
+      if (f(_values[i])) {
+        found = true;
+      }
+    }
+    return end - begin;
+  });
+
+  return found;
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, bool> collection<T>::all(Policy const& policy, std::function<bool(T)> f) const {
+  return !any(policy, [&] (T value) -> bool { return !f(value); });
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, bool> collection<T>::none(Policy const& policy, std::function<bool(T)> f) const {
+  return !any(policy, f);
+}
+
+template <typename T>
+collection<T> collection<T>::take_while(std::function<bool(T)> f) const {
+  const auto it = std::find_if_not(_values.begin(), _values.end(), f);
+
+  return collection<T>{_values.begin(), it};
+}
+
+template <typename T>
+collection<T> collection<T>::drop_while(std::function<bool(T)> f) const {
+  const auto it = std::find_if_not(_values.begin(), _values.end(), f);
+
+  return collection<T>{it, _values.end()};
+}
+
 template <typename T>
 collection<T>  collection<T>::sort(std::function<bool(T, T)> f) const {
   std::vector<T> sorted{_values};
@@ -261,6 +627,145 @@ collection<T>  collection<T>::sort(std::function<bool(T, T)> f) const {
   return collection<T>{sorted};
 }
 
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, collection<T>>
+collection<T>::sort(Policy const& policy, std::function<bool(T, T)> f) const {
+  std::vector<T> sorted{_values};
+
+  auto ranges = execute(policy, sorted.size(), [&] (std::size_t begin, std::size_t end) {
+    std::sort(sorted.begin() + begin, sorted.begin() + end, f);
+    return std::make_pair(begin, end);
+  });
+
+  // Merge neighbouring sorted chunks until one is left
+  while (ranges.size() > 1) {
+    std::vector<std::pair<std::size_t, std::size_t>> merged;
+    for (std::size_t i = 0; i + 1 < ranges.size(); i += 2) {
+      std::inplace_merge(sorted.begin() + ranges[i].first,
+                         sorted.begin() + ranges[i].second,
+                         sorted.begin() + ranges[i + 1].second, f);
+      merged.emplace_back(ranges[i].first, ranges[i + 1].second);
+    }
+    if (ranges.size() % 2 == 1) {
+      merged.push_back(ranges.back());
+    }
+    ranges = std::move(merged);
+  }
+
+  return collection<T>{std::move(sorted)};
+}
+
+template <typename T>
+collection<T> collection<T>::top_k(int k, std::function<bool(T, T)> f) const {
+  std::vector<T> top(std::min<std::size_t>(std::max(k, 0), _values.size()));
+
+  std::partial_sort_copy(_values.begin(), _values.end(), top.begin(), top.end(), f);
+
+  return collection<T>{std::move(top)};
+}
+
+template <typename T>
+collection<T> collection<T>::ptop_k(int k, std::function<bool(T, T)> f,
+                                    const unsigned long threads) const {
+  return top_k(parallel_policy{threads}, k, f);
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, collection<T>>
+collection<T>::top_k(Policy const& policy, int k, std::function<bool(T, T)> f) const {
+  const std::size_t size = std::max(k, 0);
+
+  const auto partials = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<T> top(std::min(size, end - begin));
+    std::partial_sort_copy(_values.begin() + begin, _values.begin() + end,
+                           top.begin(), top.end(), f);
+    return top;
+  });
+
+  std::vector<T> merged;
+  for (auto const& partial : partials) {
+    merged.insert(merged.end(), partial.begin(), partial.end());
+  }
+
+  return collection<T>{std::move(merged)}.top_k(k, f);
+}
+
+template <typename T>
+collection<T> collection<T>::partial_sort(int k, std::function<bool(T, T)> f) const {
+  std::vector<T> sorted{_values};
+  const auto middle = std::min<std::size_t>(std::max(k, 0), sorted.size());
+
+  std::partial_sort(sorted.begin(), sorted.begin() + middle, sorted.end(), f);
+
+  return collection<T>{std::move(sorted)};
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, collection<T>>
+collection<T>::partial_sort(Policy const& policy, int k, std::function<bool(T, T)> f) const {
+  std::vector<T> values{_values};
+  const std::size_t size = std::min<std::size_t>(std::max(k, 0), values.size());
+
+  const auto ranges = execute(policy, values.size(), [&] (std::size_t begin, std::size_t end) {
+    const auto middle = std::min(end, begin + size);
+    std::partial_sort(values.begin() + begin, values.begin() + middle, values.begin() + end, f);
+    return std::make_pair(begin, middle);
+  });
+
+  // The first k elements are among the sorted heads of the chunks
+  std::vector<T> sorted;
+  std::vector<T> rest;
+  for (std::size_t i = 0; i < ranges.size(); ++i) {
+    const auto end = (i + 1 < ranges.size()) ? ranges[i + 1].first : values.size();
+    sorted.insert(sorted.end(), values.begin() + ranges[i].first, values.begin() + ranges[i].second);
+    rest.insert(rest.end(), values.begin() + ranges[i].second, values.begin() + end);
+  }
+
+  std::partial_sort(sorted.begin(), sorted.begin() + size, sorted.end(), f);
+  sorted.insert(sorted.end(),
+                std::make_move_iterator(rest.begin()),
+                std::make_move_iterator(rest.end()));
+
+  return collection<T>{std::move(sorted)};
+}
+
+template <typename T>
+T collection<T>::nth(int k, std::function<bool(T, T)> f) const {
+  if (k < 0 || k >= _values.size()) {
+    throw std::out_of_range("Index out of range");
+  }
+
+  std::vector<T> values{_values};
+
+  std::nth_element(values.begin(), values.begin() + k, values.end(), f);
+
+  return values[k];
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, T> collection<T>::nth(Policy const& policy, int k, std::function<bool(T, T)> f) const {
+  if (k < 0 || k >= _values.size()) {
+    throw std::out_of_range("Index out of range");
+  }
+
+  const std::size_t selected = std::min<std::size_t>(k + 1, _values.size() - k);
+  if (selected * kMaxSelectFraction > _values.size()) {
+    return nth(k, f);
+  }
+
+  if (k < _values.size() / 2) {
+    return top_k(policy, k + 1, f)[k];
+  }
+
+  // Closer to the end, select from the end with the reversed predicate
+  const int index = _values.size() - 1 - k;
+  return top_k(policy, index + 1, [&] (T a, T b) -> bool { return f(b, a); })[index];
+}
+
 template <typename T>
 template <typename Function>
 collection<typename std::result_of<Function(T)>::type> collection<T>::map(Function f) const {
@@ -275,43 +780,31 @@ collection<typename std::result_of<Function(T)>::type> collection<T>::map(Functi
   return collection<return_type>(values);
 }
 
-template<typename T, typename Function>
-void pmap_thread(int begin, int end, Function func, std::vector<T>& values) {
-  for (int i = begin; i < end && i < values.size(); ++i) {
-    values[i] = func(values[i]);
-  }
-}
-
 template <typename T>
 template <typename Function>
 collection<typename std::result_of<Function(T)>::type>
 collection<T>::pmap(Function func, const unsigned long threads) const
 {
-  std::vector<std::thread> thread_pool(threads);
-  const unsigned long chunk = _values.size() / threads;
-  const unsigned long extra = _values.size() - chunk*threads;
-  std::vector<int> indices(extra, chunk + 1);
-  std::vector<int> normal(threads - extra, chunk);
-  indices.insert(indices.end(), normal.begin(), normal.end());
-  std::vector<T> values { _values };
-
-  int start = 0;
-
-  for (int i = 0; i < threads; ++i) {
-    int end = start + indices[i];
-
-    thread_pool[i] = std::thread ([=, &values]() {
-      pmap_thread(start, end, func, values);
-    });
+  return map(parallel_policy{threads}, func);
+}
 
-    start = end;
-  }
+template <typename T>
+template <typename Policy, typename Function>
+enable_if_policy<Policy, collection<typename std::result_of<Function(T)>::type>>
+collection<T>::map(Policy const& policy, Function f) const
+{
+  using return_type = typename std::result_of<Function(T)>::type;
 
-  for (int i = 0; i < threads; ++i) {
-    thread_pool[i].join();
-  }
+  auto partials = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<return_type> values;
+    values.reserve(end - begin);
+    for (auto i = begin; i < end; ++i) {
+      values.push_back(f(_values[i]));
+    }
+    return values;
+  });
 
-  return collection<T>{ values };
+  return collection<return_type>{concat_partials(partials)};
 }
 
 template <typename T>
@@ -333,6 +826,30 @@ T collection<T>::reduce(std::function<T(T, T)> f) const
   return value;
 }
 
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, T> collection<T>::reduce(Policy const& policy, std::function<T(T, T)> f) const
+{
+  if (_values.empty()) {
+    throw std::runtime_error("Empty collection");
+  }
+
+  const auto partials = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    std::optional<T> value{_values[begin]};
+    for (auto i = begin + 1; i < end; ++i) {
+      value = f(*value, _values[i]);
+    }
+    return value;
+  });
+
+  T value{*partials[0]};
+  for (int i = 1; i < partials.size(); ++i) {
+    value = f(value, *partials[i]);
+  }
+
+  return value;
+}
+
 template <typename T>
 T collection<T>::rightreduce(std::function<T(T, T)> f) const {
   if (_values.empty()) {
@@ -402,21 +919,244 @@ collection<T>::foldr(Function f, I init) const {
 template <typename T>
 collection<T>
 collection<T>::concat(const collection<T>& c) const {
-  const auto firstSize = _values.size();
-  const auto secondSize = c.size();
-  const auto totalSize = firstSize + secondSize;
+  std::vector<T> values;
+  values.reserve(_values.size() + c._values.size());
+
+  values.insert(values.end(), _values.begin(), _values.end());
+  values.insert(values.end(), c._values.begin(), c._values.end());
 
-  std::vector<T> values(totalSize);
+  return collection<T>(std::move(values));
+}
+
+template <typename T>
+collection<T> collection<T>::scan(std::function<T(T, T)> f) const {
+  std::vector<T> values;
+  values.reserve(_values.size());
 
-  for (auto i{0}; i < firstSize; ++i) {
-    values[i] = _values[i];
+  for (auto const& value : _values) {
+    values.push_back(values.empty() ? value : f(values.back(), value));
   }
 
-  for (auto i{0}; i < secondSize; ++i) {
-    values[firstSize + i] = c[i];
+  return collection<T>{std::move(values)};
+}
+
+template <typename T>
+collection<T> collection<T>::pscan(std::function<T(T, T)> f,
+                                   const unsigned long threads) const {
+  return scan(parallel_policy{threads}, f);
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, collection<T>>
+collection<T>::scan(Policy const& policy, std::function<T(T, T)> f) const {
+  if (_values.empty()) {
+    return collection<T>{};
   }
 
-  return collection<T>(values);
+  // First pass: scan each chunk independently
+  auto partials = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<T> values;
+    values.reserve(end - begin);
+    values.push_back(_values[begin]);
+    for (auto i = begin + 1; i < end; ++i) {
+      values.push_back(f(values.back(), _values[i]));
+    }
+    return values;
+  });
+
+  // Combine the totals of the previous chunks, in order
+  std::vector<std::optional<T>> carries(partials.size());
+  for (std::size_t i = 1; i < partials.size(); ++i) {
+    const T& total = partials[i - 1].back();
+    carries[i] = carries[i - 1] ? f(*carries[i - 1], total) : total;
+  }
+
+  // Start of each chunk in the collection
+  std::vector<std::size_t> offsets(partials.size() + 1);
+  for (std::size_t i = 0; i < partials.size(); ++i) {
+    offsets[i + 1] = offsets[i] + partials[i].size();
+  }
+
+  // Second pass: add the carry of the previous chunks to each element
+  auto results = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    std::vector<T> values;
+    values.reserve(end - begin);
+    std::size_t chunk = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+    for (auto i = begin; i < end; ++i) {
+      if (i >= offsets[chunk + 1]) {
+        ++chunk;
+      }
+      const T& value = partials[chunk][i - offsets[chunk]];
+      values.push_back(carries[chunk] ? f(*carries[chunk], value) : value);
+    }
+    return values;
+  });
+
+  return collection<T>{concat_partials(results)};
+}
+
+template <typename T>
+template <typename Function, typename I>
+collection<typename std::result_of<Function(I, T)>::type>
+collection<T>::scanl(Function f, I init) const {
+  using return_type = typename std::result_of<Function(I, T)>::type;
+  static_assert(std::is_same<return_type, I>::value,
+      "Initial value and return value do not match");
+
+  std::vector<return_type> values;
+  values.reserve(_values.size() + 1);
+  values.push_back(init);
+
+  for (auto const& value : _values) {
+    values.push_back(f(values.back(), value));
+  }
+
+  return collection<return_type>{std::move(values)};
+}
+
+template <typename T>
+template <typename Function, typename I>
+collection<typename std::result_of<Function(I, T)>::type>
+collection<T>::scanr(Function f, I init) const {
+  using return_type = typename std::result_of<Function(I, T)>::type;
+  static_assert(std::is_same<return_type, I>::value,
+      "Initial value and return value do not match");
+
+  std::vector<return_type> values;
+  values.reserve(_values.size() + 1);
+  values.push_back(init);
+
+  for (auto it = _values.rbegin(); it != _values.rend(); ++it) {
+    values.push_back(f(values.back(), *it));
+  }
+
+  std::reverse(values.begin(), values.end());
+
+  return collection<return_type>{std::move(values)};
+}
+
+template <typename T>
+template <typename U>
+collection<std::pair<T, U>> collection<T>::zip(collection<U> const& other) const {
+  return zip_with(other, [] (T const& a, U const& b) { return std::make_pair(a, b); });
+}
+
+template <typename T>
+template <typename Policy, typename U>
+enable_if_policy<Policy, collection<std::pair<T, U>>>
+collection<T>::zip(Policy const& policy, collection<U> const& other) const {
+  return zip_with(policy, other, [] (T const& a, U const& b) { return std::make_pair(a, b); });
+}
+
+template <typename T>
+template <typename U, typename Function>
+collection<typename std::result_of<Function(T, U)>::type>
+collection<T>::zip_with(collection<U> const& other, Function f) const {
+  using return_type = typename std::result_of<Function(T, U)>::type;
+  const auto size = std::min(_values.size(), other._values.size());
+
+  std::vector<return_type> values;
+  values.reserve(size);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    values.push_back(f(_values[i], other._values[i]));
+  }
+
+  return collection<return_type>{std::move(values)};
+}
+
+template <typename T>
+template <typename Policy, typename U, typename Function>
+enable_if_policy<Policy, collection<typename std::result_of<Function(T, U)>::type>>
+collection<T>::zip_with(Policy const& policy, collection<U> const& other, Function f) const {
+  using return_type = typename std::result_of<Function(T, U)>::type;
+  const auto size = std::min(_values.size(), other._values.size());
+
+  auto partials = execute(policy, size, [&] (std::size_t begin, std::size_t end) {
+    std::vector<return_type> values;
+    values.reserve(end - begin);
+    for (auto i = begin; i < end; ++i) {
+      values.push_back(f(_values[i], other._values[i]));
+    }
+    return values;
+  });
+
+  return collection<return_type>{concat_partials(partials)};
+}
+
+template <typename T>
+template <typename U>
+std::vector<U> collection<T>::concat_partials(std::vector<std::vector<U>>& partials) {
+  std::size_t size = 0;
+  for (auto const& partial : partials) {
+    size += partial.size();
+  }
+
+  std::vector<U> values;
+  values.reserve(size);
+  for (auto& partial : partials) {
+    values.insert(values.end(),
+                  std::make_move_iterator(partial.begin()),
+                  std::make_move_iterator(partial.end()));
+  }
+
+  return values;
+}
+
+template <typename T>
+template <typename Sketch, typename Policy>
+Sketch collection<T>::psketch(Sketch const& empty, Policy const& policy) const {
+  auto sketches = execute(policy, _values.size(), [&] (std::size_t begin, std::size_t end) {
+    Sketch sketch{empty};
+    for (auto i = begin; i < end; ++i) {
+      sketch.add(_values[i]);
+    }
+    return sketch;
+  });
+
+  for (int i = 1; i < sketches.size(); ++i) {
+    sketches[0].merge(sketches[i]);
+  }
+
+  return sketches[0];
+}
+
+template <typename T>
+double collection<T>::approx_distinct(const unsigned long threads) const {
+  return approx_distinct(parallel_policy{threads});
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, double> collection<T>::approx_distinct(Policy const& policy) const {
+  return psketch(hyperloglog<T>{}, policy).estimate();
+}
+
+template <typename T>
+T collection<T>::approx_quantile(double q, const unsigned long threads) const {
+  return approx_quantile(parallel_policy{threads}, q);
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, T> collection<T>::approx_quantile(Policy const& policy, double q) const {
+  if (_values.empty()) {
+    throw std::runtime_error("Empty collection");
+  }
+
+  return psketch(kll_sketch<T>{}, policy).quantile(q);
+}
+
+template <typename T>
+count_min_sketch<T> collection<T>::approx_frequency(const unsigned long threads) const {
+  return approx_frequency(parallel_policy{threads});
+}
+
+template <typename T>
+template <typename Policy>
+enable_if_policy<Policy, count_min_sketch<T>> collection<T>::approx_frequency(Policy const& policy) const {
+  return psketch(count_min_sketch<T>{}, policy);
 }
 
 }
@@ -0,0 +1,217 @@
+/*
+
+MIT License
+
+Copyright (c) 2018 Matteo Ugolotti
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fp
+{
+
+// Maximum number of threads for concurrent functions
+static const int kMaxThreads = 4;
+
+// Time spent measuring the cost of a function before the adaptive policy
+// decides how to run the rest of the collection
+static const std::chrono::nanoseconds kCalibrationTime = std::chrono::microseconds{20};
+
+// Minimum estimated work worth starting a thread for
+static const std::chrono::nanoseconds kMinTaskTime = std::chrono::microseconds{100};
+
+// Minimum number of chunks the adaptive policy measures, so that the fixed cost
+// of a chunk can be told apart from the cost of its elements
+static const std::size_t kMinCalibrationChunks = 4;
+
+// Minimum number of elements the adaptive policy gives to each thread
+static const std::size_t kMinGrain = 32;
+
+// Minimum time of a calibration chunk for its measure to be trusted,
+// shorter chunks are dominated by the resolution of the clock
+static const std::chrono::nanoseconds kMinSampleTime = std::chrono::microseconds{1};
+
+// Splits [0, size) into at most threads contiguous [begin, end) ranges of similar length
+inline std::vector<std::pair<std::size_t, std::size_t>>
+chunk_ranges(std::size_t size, unsigned long threads) {
+  const std::size_t count = std::max<std::size_t>(1, std::min<std::size_t>(threads, size));
+  const std::size_t chunk = size / count;
+  const std::size_t extra = size - chunk*count;
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+
+  std::size_t start = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t end = start + chunk + (i < extra ? 1 : 0);
+    ranges.emplace_back(start, end);
+    start = end;
+  }
+
+  return ranges;
+}
+
+// Runs on the calling thread
+struct sequenced_policy
+{
+};
+
+// Runs on the given number of threads
+struct parallel_policy
+{
+  unsigned long threads = kMaxThreads;
+};
+
+// Runs on the given number of threads, functions must not synchronize with each other.
+// Chunks are already processed by plain loops the compiler is free to vectorize,
+// so this behaves as parallel_policy
+struct parallel_unsequenced_policy
+{
+  unsigned long threads = kMaxThreads;
+};
+
+// Measures the cost of the function on the first elements, then runs the rest
+// on the calling thread or on as many threads as the estimated work is worth
+struct adaptive_policy
+{
+  unsigned long max_threads = std::max(1u, std::thread::hardware_concurrency());
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+inline const adaptive_policy adaptive{};
+
+template <typename Policy>
+struct is_execution_policy :
+  std::integral_constant<bool,
+    std::is_same<Policy, sequenced_policy>::value ||
+    std::is_same<Policy, parallel_policy>::value ||
+    std::is_same<Policy, parallel_unsequenced_policy>::value ||
+    std::is_same<Policy, adaptive_policy>::value> {
+};
+
+template <typename Policy, typename R = void>
+using enable_if_policy = typename std::enable_if<is_execution_policy<typename std::decay<Policy>::type>::value, R>::type;
+
+// Calls body(begin, end) on each range, concurrently if requested,
+// and stores the results in order after the existing ones
+template <typename Body, typename R>
+void run_ranges(std::vector<std::pair<std::size_t, std::size_t>> const& ranges,
+                Body& body, bool concurrent, std::vector<R>& results) {
+  const auto offset = results.size();
+  results.resize(offset + ranges.size());
+
+  if (!concurrent || ranges.size() == 1) {
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+      results[offset + i] = body(ranges[i].first, ranges[i].second);
+    }
+    return;
+  }
+
+  std::vector<std::thread> thread_pool(ranges.size());
+
+  for (std::size_t i = 0; i < ranges.size(); ++i) {
+    thread_pool[i] = std::thread ([&, i]() {
+      results[offset + i] = body(ranges[i].first, ranges[i].second);
+    });
+  }
+
+  for (std::size_t i = 0; i < ranges.size(); ++i) {
+    thread_pool[i].join();
+  }
+}
+
+// Splits [0, size) into contiguous chunks according to the policy, calls body(begin, end)
+// on each of them and returns the results of the chunks in order.
+// Chunks may run concurrently, so body must only write to its own chunk.
+template <typename Policy, typename Body>
+std::vector<typename std::result_of<Body&(std::size_t, std::size_t)>::type>
+execute(Policy const& policy, std::size_t size, Body body) {
+  using result_type = typename std::result_of<Body&(std::size_t, std::size_t)>::type;
+  std::vector<result_type> results;
+
+  if constexpr (std::is_same<Policy, sequenced_policy>::value) {
+    run_ranges(chunk_ranges(size, 1), body, false, results);
+  } else if constexpr (std::is_same<Policy, adaptive_policy>::value) {
+    using clock = std::chrono::steady_clock;
+    using nanoseconds = std::chrono::duration<double, std::nano>;
+    const auto start = clock::now();
+    std::size_t done = 0;
+    std::size_t step = 1;
+    std::vector<std::pair<std::size_t, double>> samples;
+
+    // Run doubling chunks serially until the cost per element is known,
+    // only chunks long enough to be measured reliably are kept
+    do {
+      const auto chunk_start = clock::now();
+      const auto end = std::min(size, done + step);
+      results.push_back(body(done, end));
+      const auto elapsed = nanoseconds(clock::now() - chunk_start).count();
+      if (elapsed >= kMinSampleTime.count()) {
+        samples.emplace_back(end - done, elapsed);
+      }
+      done = end;
+      step *= 2;
+    } while (done < size && (samples.size() < kMinCalibrationChunks ||
+                             clock::now() - start < kCalibrationTime));
+
+    if (done == size) {
+      return results;
+    }
+
+    // Bodies may have a fixed cost per chunk, such as allocating a partial result,
+    // so the time of a chunk is not proportional to its size. The difference between
+    // the two largest chunks cancels the fixed cost out; when noise makes it meaningless
+    // the average cost of the largest chunk is used instead.
+    const auto last = samples.back();
+    const auto previous = samples[samples.size() - 2];
+    const auto average = last.second / last.first;
+    const auto marginal = (last.second - previous.second) / (last.first - previous.first);
+    const auto cost = marginal > 0 ? std::min(marginal, average) : average;
+
+    const auto remaining = size - done;
+    const auto estimate = cost * remaining;
+    const auto threads = std::clamp<unsigned long>(
+        std::min<double>(estimate / kMinTaskTime.count(), remaining / kMinGrain),
+        1, std::max<unsigned long>(1, policy.max_threads));
+
+    auto ranges = chunk_ranges(remaining, threads);
+    for (auto& range : ranges) {
+      range.first += done;
+      range.second += done;
+    }
+
+    run_ranges(ranges, body, threads > 1, results);
+  } else {
+    run_ranges(chunk_ranges(size, policy.threads), body, true, results);
+  }
+
+  return results;
+}
+
+}
@@ -0,0 +1,255 @@
+/*
+
+MIT License
+
+Copyright (c) 2018 Matteo Ugolotti
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "collections.hpp"
+
+namespace fp
+{
+
+// A collection of at most N objects, backed by a std::array, whose functions
+// can be evaluated at compile time. filter may return fewer than N elements,
+// so the number of elements in use is tracked separately from the capacity.
+// T must be a literal, default constructible type.
+template <typename T, std::size_t N>
+class fixed_collection
+{
+  private:
+    std::array<T, N> _values;
+    std::size_t _size;
+
+    template <typename U, std::size_t M>
+    friend class fixed_collection;
+
+    static constexpr void swap(T& a, T& b) {
+      T tmp = a;
+      a = b;
+      b = tmp;
+    }
+
+    // Moves the element at index down the heap [0, size)
+    template <typename Function>
+    static constexpr void sift_down(std::array<T, N>& values, std::size_t index,
+                                    std::size_t size, Function f) {
+      for (std::size_t child = 2 * index + 1; child < size; child = 2 * index + 1) {
+        if (child + 1 < size && f(values[child], values[child + 1])) {
+          ++child;
+        }
+
+        if (!f(values[index], values[child])) {
+          return;
+        }
+
+        swap(values[index], values[child]);
+        index = child;
+      }
+    }
+
+  public:
+    // Constructor for empty collection
+    constexpr fixed_collection() :
+      _values{},
+      _size{0} {
+    }
+
+    // Throws if the list has more than N elements
+    constexpr fixed_collection(std::initializer_list<T> values) :
+      _values{},
+      _size{0} {
+      if (values.size() > N) {
+        throw std::length_error("Too many elements");
+      }
+
+      for (auto const& value : values) {
+        _values[_size++] = value;
+      }
+    }
+
+    // Array constructor
+    constexpr fixed_collection(std::array<T, N> const& values) :
+      _values{values},
+      _size{N} {
+    }
+
+    // Overload operator []
+    constexpr T operator[](const std::size_t index) const {
+      return _values[index];
+    }
+
+    // Overload operator ==
+    constexpr bool operator==(fixed_collection<T, N> const& other) const {
+      if (_size != other._size) {
+        return false;
+      }
+
+      for (std::size_t i = 0; i < _size; ++i) {
+        if (!(_values[i] == other._values[i])) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    // Returns the size of the collection
+    constexpr std::size_t size() const {
+      return _size;
+    }
+
+    // Returns the maximum number of elements of the collection
+    static constexpr std::size_t capacity() {
+      return N;
+    }
+
+    // Return collection as a std::vector
+    std::vector<T> vector() const {
+      return std::vector<T>{_values.begin(), _values.begin() + _size};
+    }
+
+    // Return the collection as an fp::collection
+    fp::collection<T> collection() const {
+      return fp::collection<T>{vector()};
+    }
+
+    // Returns a new collection, as the result of the application of the given function
+    // to each element of the initial collection
+    template <typename Function>
+    constexpr fixed_collection<typename std::result_of<Function(T)>::type, N>
+    map(Function f) const;
+
+    // Returns a subset of the collection, filtered by the given predicate
+    template <typename Function>
+    constexpr fixed_collection<T, N> filter(Function f) const;
+
+    // Returns a copy of the Collection, sorted according to the given predicate
+    template <typename Function>
+    constexpr fixed_collection<T, N> sort(Function f) const;
+
+    // Returns the result of the application of the binary operator on the Collection
+    // starting from the first element
+    // Throws if the collection is empty
+    template <typename Function>
+    constexpr T reduce(Function f) const;
+
+    // Returns the result of the application of a binary operator on
+    // all elements in the Collection from a given initial value, starting
+    // from the first element
+    // Throws if the Collection is empty
+    template <typename Function, typename I>
+    constexpr typename std::result_of<Function(I, T)>::type
+    fold(Function f, I init) const;
+};
+
+template <typename T, std::size_t N>
+template <typename Function>
+constexpr fixed_collection<typename std::result_of<Function(T)>::type, N>
+fixed_collection<T, N>::map(Function f) const {
+  fixed_collection<typename std::result_of<Function(T)>::type, N> result{};
+
+  for (std::size_t i = 0; i < _size; ++i) {
+    result._values[i] = f(_values[i]);
+  }
+  result._size = _size;
+
+  return result;
+}
+
+template <typename T, std::size_t N>
+template <typename Function>
+constexpr fixed_collection<T, N> fixed_collection<T, N>::filter(Function f) const {
+  fixed_collection<T, N> result{};
+
+  for (std::size_t i = 0; i < _size; ++i) {
+    if (f(_values[i])) {
+      result._values[result._size++] = _values[i];
+    }
+  }
+
+  return result;
+}
+
+template <typename T, std::size_t N>
+template <typename Function>
+constexpr fixed_collection<T, N> fixed_collection<T, N>::sort(Function f) const {
+  // std::sort is not constexpr before C++20, use an in place heap sort
+  fixed_collection<T, N> result{*this};
+
+  for (std::size_t i = _size / 2; i > 0; --i) {
+    sift_down(result._values, i - 1, _size, f);
+  }
+
+  for (std::size_t end = _size; end > 1; --end) {
+    swap(result._values[0], result._values[end - 1]);
+    sift_down(result._values, 0, end - 1, f);
+  }
+
+  return result;
+}
+
+template <typename T, std::size_t N>
+template <typename Function>
+constexpr T fixed_collection<T, N>::reduce(Function f) const {
+  if (_size == 0) {
+    throw std::runtime_error("Empty collection");
+  }
+
+  T value = _values[0];
+  for (std::size_t i = 1; i < _size; ++i) {
+    value = f(value, _values[i]);
+  }
+
+  return value;
+}
+
+template <typename T, std::size_t N>
+template <typename Function, typename I>
+constexpr typename std::result_of<Function(I, T)>::type
+fixed_collection<T, N>::fold(Function f, I init) const {
+  using return_type = typename std::result_of<Function(I, T)>::type;
+  static_assert(std::is_same<return_type, I>::value,
+      "Initial value and return value do not match");
+
+  if (_size == 0) {
+    throw std::runtime_error("Collection is empty");
+  }
+
+  return_type value = init;
+  for (std::size_t i = 0; i < _size; ++i) {
+    value = f(value, _values[i]);
+  }
+
+  return value;
+}
+
+}
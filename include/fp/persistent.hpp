@@ -0,0 +1,437 @@
+/*
+
+MIT License
+
+Copyright (c) 2018 Matteo Ugolotti
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "collections.hpp"
+
+namespace fp
+{
+
+// Maximum number of elements stored in a single leaf of a persistent collection
+static const std::size_t kChunkSize = 32;
+
+// A node of the balanced tree backing a persistent collection.
+// Leaves hold up to kChunkSize elements, inner nodes hold two subtrees.
+// Nodes are never modified once built, so they can be shared freely,
+// also between threads.
+template <typename T>
+struct persistent_node
+{
+  using ptr = std::shared_ptr<const persistent_node<T>>;
+
+  ptr left;
+  ptr right;
+  std::vector<T> chunk;
+  std::size_t size;
+  int height;
+};
+
+// An immutable collection backed by a balanced tree of chunks.
+// concat, append, tail and slice share structure with their operands
+// and run in O(log n) instead of copying the whole collection.
+template <typename T>
+class persistent_collection
+{
+  private:
+    using node = persistent_node<T>;
+    using node_ptr = typename node::ptr;
+
+    node_ptr _root;
+
+    persistent_collection<T>(node_ptr root) :
+      _root{std::move(root)} {
+    }
+
+    static std::size_t size_of(node_ptr const& n) {
+      return n ? n->size : 0;
+    }
+
+    static int height_of(node_ptr const& n) {
+      return n ? n->height : 0;
+    }
+
+    static node_ptr make_leaf(std::vector<T> chunk) {
+      const auto size = chunk.size();
+      return std::make_shared<const node>(node{nullptr, nullptr, std::move(chunk), size, 1});
+    }
+
+    static node_ptr make_node(node_ptr left, node_ptr right) {
+      const auto size = left->size + right->size;
+      const auto height = std::max(left->height, right->height) + 1;
+      return std::make_shared<const node>(node{std::move(left), std::move(right), {}, size, height});
+    }
+
+    // Builds a node from two subtrees whose heights differ by at most two
+    static node_ptr balance(node_ptr left, node_ptr right);
+
+    // Concatenates two trees, keeping the result balanced
+    static node_ptr join(node_ptr left, node_ptr right);
+
+    // Splits a tree into its first index elements and the remaining ones
+    static std::pair<node_ptr, node_ptr> split(node_ptr const& n, std::size_t index);
+
+    // Builds a balanced tree from a range of elements
+    template <class Iterator>
+    static node_ptr build(Iterator begin, Iterator end);
+
+    // Visits every leaf from left to right
+    template <typename Function>
+    static void visit(node_ptr const& n, Function f);
+
+  public:
+    // Constructor for empty collection
+    persistent_collection<T>() :
+      _root{} {
+    }
+
+    persistent_collection<T>(std::initializer_list<T> values) :
+      _root{build(values.begin(), values.end())} {
+    }
+
+    // Builds a collection from iterators
+    template <class Iterator>
+    persistent_collection<T>(Iterator begin,
+                             Iterator end) :
+      _root{build(begin, end)} {
+    }
+
+    // Vector constructor
+    persistent_collection<T>(std::vector<T> const& v) :
+      _root{build(v.begin(), v.end())} {
+    }
+
+    // fp::collection constructor
+    persistent_collection<T>(fp::collection<T> const& c) :
+      persistent_collection<T>{c.vector()} {
+    }
+
+    // Overload operator []
+    T const& operator[](const int index) const;
+
+    // Overload operator ==
+    bool operator==(persistent_collection<T> const& other) const {
+      return vector() == other.vector();
+    }
+
+    // Return collection as a std::vector
+    std::vector<T> vector() const;
+
+    // Return the collection as a std::list
+    std::list<T> list() const {
+      const auto values = vector();
+      return std::list<T>{values.begin(), values.end()};
+    }
+
+    // Return the collection as an fp::collection
+    fp::collection<T> collection() const {
+      return fp::collection<T>{vector()};
+    }
+
+    // Overload the << operator
+    friend std::ostream &operator<<(std::ostream &stream, persistent_collection<T> const& f) {
+      stream << "[";
+
+      bool first = true;
+      f.each([&] (T const& value) {
+        if (!first) {
+          stream << ",";
+        }
+        stream << value;
+        first = false;
+      });
+
+      stream << "]";
+
+      return stream;
+    }
+
+    // Returns the size of the collection
+    int size() const;
+
+    // Returns only the first element of the collection
+    // Throws if the collection is empty
+    T head() const;
+
+    // Returns the collection without its first element, sharing the rest
+    persistent_collection<T> tail() const;
+
+    // Applies a function to each element of the collection
+    template <typename Function>
+    void each(Function f) const;
+
+    // Returns the [begin, end) subset of the collection, sharing structure
+    // Throws if the range is out of bounds
+    persistent_collection<T> slice(int begin, int end) const;
+
+    // Returns a new collection with the given element added at the end
+    persistent_collection<T> append(T const& value) const;
+
+    // Returns the concatenation of two collections, sharing both operands
+    persistent_collection<T> concat(const persistent_collection<T>&) const;
+};
+
+template <typename T>
+typename persistent_collection<T>::node_ptr
+persistent_collection<T>::balance(node_ptr left, node_ptr right)
+{
+  const auto hl = height_of(left);
+  const auto hr = height_of(right);
+
+  if (hl > hr + 1) {
+    if (height_of(left->left) >= height_of(left->right)) {
+      return make_node(left->left, make_node(left->right, std::move(right)));
+    }
+
+    return make_node(make_node(left->left, left->right->left),
+                     make_node(left->right->right, std::move(right)));
+  }
+
+  if (hr > hl + 1) {
+    if (height_of(right->right) >= height_of(right->left)) {
+      return make_node(make_node(std::move(left), right->left), right->right);
+    }
+
+    return make_node(make_node(std::move(left), right->left->left),
+                     make_node(right->left->right, right->right));
+  }
+
+  return make_node(std::move(left), std::move(right));
+}
+
+template <typename T>
+typename persistent_collection<T>::node_ptr
+persistent_collection<T>::join(node_ptr left, node_ptr right)
+{
+  if (!left || left->size == 0) {
+    return right;
+  }
+
+  if (!right || right->size == 0) {
+    return left;
+  }
+
+  // Merge small neighbouring leaves to keep chunks dense
+  if (left->height == 1 && right->height == 1 &&
+      left->size + right->size <= kChunkSize) {
+    std::vector<T> chunk;
+    chunk.reserve(left->size + right->size);
+    chunk.insert(chunk.end(), left->chunk.begin(), left->chunk.end());
+    chunk.insert(chunk.end(), right->chunk.begin(), right->chunk.end());
+    return make_leaf(std::move(chunk));
+  }
+
+  if (left->height > right->height + 1) {
+    return balance(left->left, join(left->right, std::move(right)));
+  }
+
+  if (right->height > left->height + 1) {
+    return balance(join(std::move(left), right->left), right->right);
+  }
+
+  return make_node(std::move(left), std::move(right));
+}
+
+template <typename T>
+std::pair<typename persistent_collection<T>::node_ptr, typename persistent_collection<T>::node_ptr>
+persistent_collection<T>::split(node_ptr const& n, std::size_t index)
+{
+  if (index == 0) {
+    return {nullptr, n};
+  }
+
+  if (index >= size_of(n)) {
+    return {n, nullptr};
+  }
+
+  if (n->height == 1) {
+    return {make_leaf(std::vector<T>{n->chunk.begin(), n->chunk.begin() + index}),
+            make_leaf(std::vector<T>{n->chunk.begin() + index, n->chunk.end()})};
+  }
+
+  const auto leftSize = n->left->size;
+  if (index < leftSize) {
+    auto parts = split(n->left, index);
+    return {std::move(parts.first), join(std::move(parts.second), n->right)};
+  }
+
+  auto parts = split(n->right, index - leftSize);
+  return {join(n->left, std::move(parts.first)), std::move(parts.second)};
+}
+
+template <typename T>
+template <class Iterator>
+typename persistent_collection<T>::node_ptr
+persistent_collection<T>::build(Iterator begin, Iterator end)
+{
+  std::vector<node_ptr> level;
+  std::vector<T> chunk;
+
+  for (auto it = begin; it != end; ++it) {
+    chunk.push_back(*it);
+    if (chunk.size() == kChunkSize) {
+      level.push_back(make_leaf(std::move(chunk)));
+      chunk = std::vector<T>{};
+    }
+  }
+
+  if (!chunk.empty()) {
+    level.push_back(make_leaf(std::move(chunk)));
+  }
+
+  if (level.empty()) {
+    return nullptr;
+  }
+
+  // Pair up nodes bottom-up, the result is a complete, balanced tree
+  while (level.size() > 1) {
+    std::vector<node_ptr> next;
+    for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+      next.push_back(join(level[i], level[i + 1]));
+    }
+    if (level.size() % 2 == 1) {
+      auto last = level.back();
+      next.back() = join(next.back(), std::move(last));
+    }
+    level = std::move(next);
+  }
+
+  return level[0];
+}
+
+template <typename T>
+template <typename Function>
+void persistent_collection<T>::visit(node_ptr const& n, Function f)
+{
+  if (!n) {
+    return;
+  }
+
+  if (n->height == 1) {
+    f(n->chunk);
+    return;
+  }
+
+  visit(n->left, f);
+  visit(n->right, f);
+}
+
+template <typename T>
+T const& persistent_collection<T>::operator[](const int index) const
+{
+  std::size_t i = index;
+  const node* n = _root.get();
+
+  while (n->height > 1) {
+    if (i < n->left->size) {
+      n = n->left.get();
+    } else {
+      i -= n->left->size;
+      n = n->right.get();
+    }
+  }
+
+  return n->chunk[i];
+}
+
+template <typename T>
+std::vector<T> persistent_collection<T>::vector() const
+{
+  std::vector<T> values;
+  values.reserve(size_of(_root));
+
+  visit(_root, [&] (std::vector<T> const& chunk) {
+    values.insert(values.end(), chunk.begin(), chunk.end());
+  });
+
+  return values;
+}
+
+template <typename T>
+int persistent_collection<T>::size() const
+{
+  return size_of(_root);
+}
+
+template <typename T>
+T persistent_collection<T>::head() const
+{
+  return (size_of(_root) > 0) ? (*this)[0]
+                              : throw std::runtime_error("Empty collection");
+}
+
+template <typename T>
+persistent_collection<T> persistent_collection<T>::tail() const
+{
+  return (size_of(_root) > 0) ? slice(1, size())
+                              : persistent_collection<T>{};
+}
+
+template <typename T>
+template <typename Function>
+void persistent_collection<T>::each(Function f) const
+{
+  visit(_root, [&] (std::vector<T> const& chunk) {
+    for (auto const& value : chunk) {
+      f(value);
+    }
+  });
+}
+
+template <typename T>
+persistent_collection<T> persistent_collection<T>::slice(int begin, int end) const
+{
+  if (begin < 0 || end < begin || end > size()) {
+    throw std::out_of_range("Invalid slice range");
+  }
+
+  const auto prefix = split(_root, end).first;
+  return persistent_collection<T>(split(prefix, begin).second);
+}
+
+template <typename T>
+persistent_collection<T> persistent_collection<T>::append(T const& value) const
+{
+  return persistent_collection<T>(join(_root, make_leaf(std::vector<T>{value})));
+}
+
+template <typename T>
+persistent_collection<T>
+persistent_collection<T>::concat(const persistent_collection<T>& c) const
+{
+  return persistent_collection<T>(join(_root, c._root));
+}
+
+}
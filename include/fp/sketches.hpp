@@ -0,0 +1,297 @@
+/*
+
+MIT License
+
+Copyright (c) 2018 Matteo Ugolotti
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fp
+{
+
+// Default number of bits of the hash used to select a HyperLogLog register
+static const int kHllPrecision = 12;
+
+// Default number of elements kept by the top level of a KLL sketch
+static const int kKllCapacity = 200;
+
+// Default dimensions of a count-min sketch
+static const int kCountMinWidth = 2048;
+static const int kCountMinDepth = 4;
+
+// Mixes the bits of a hash, std::hash is the identity for integers on most platforms
+inline std::uint64_t mix_hash(std::uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+// Estimates the number of distinct elements with a fixed number of registers
+// The relative error is about 1.04 / sqrt(2^precision)
+template <typename T>
+class hyperloglog
+{
+  private:
+    int _precision;
+    std::vector<std::uint8_t> _registers;
+
+  public:
+    hyperloglog<T>(int precision = kHllPrecision) :
+      _precision{precision},
+      _registers(std::size_t{1} << precision, 0) {
+    }
+
+    void add(T const& value) {
+      const auto h = mix_hash(std::hash<T>{}(value));
+      const auto index = h >> (64 - _precision);
+      const auto rest = (h << _precision) | (std::uint64_t{1} << (_precision - 1));
+      std::uint8_t rank = 1;
+      for (auto bit = std::uint64_t{1} << 63; !(rest & bit); bit >>= 1) {
+        ++rank;
+      }
+      _registers[index] = std::max(_registers[index], rank);
+    }
+
+    // Throws if the sketches have a different precision
+    void merge(hyperloglog<T> const& other) {
+      if (_precision != other._precision) {
+        throw std::invalid_argument("Sketches do not match");
+      }
+
+      for (std::size_t i = 0; i < _registers.size(); ++i) {
+        _registers[i] = std::max(_registers[i], other._registers[i]);
+      }
+    }
+
+    double estimate() const {
+      const double m = _registers.size();
+      double sum = 0;
+      int zeros = 0;
+
+      for (const auto r : _registers) {
+        sum += std::ldexp(1.0, -r);
+        zeros += (r == 0);
+      }
+
+      const double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+
+      // Linear counting is more accurate for small cardinalities
+      if (estimate <= 2.5 * m && zeros > 0) {
+        return m * std::log(m / zeros);
+      }
+
+      return estimate;
+    }
+};
+
+// Estimates quantiles keeping a number of elements logarithmic in the size of the input
+// Elements are kept in levels, an element at level h standing for 2^h input elements.
+// When the sketch is full the lowest full level is sorted and every other element
+// is promoted to the next one.
+template <typename T>
+class kll_sketch
+{
+  private:
+    int _capacity;
+    std::size_t _count;
+    std::size_t _retained;
+    std::size_t _max_retained;
+    std::vector<std::vector<T>> _levels;
+    std::minstd_rand _random;
+
+    std::size_t level_capacity(std::size_t level) const {
+      const auto depth = _levels.size() - level - 1;
+      return std::max<std::size_t>(2, _capacity * std::pow(2.0 / 3.0, depth));
+    }
+
+    void add_level() {
+      _levels.emplace_back();
+      _max_retained = 0;
+      for (std::size_t level = 0; level < _levels.size(); ++level) {
+        _max_retained += level_capacity(level);
+      }
+    }
+
+    // Compacts the lowest full level until the sketch is within its capacity
+    void compress() {
+      while (_retained >= _max_retained) {
+        std::size_t level = 0;
+        while (_levels[level].size() < level_capacity(level)) {
+          ++level;
+        }
+
+        if (level + 1 == _levels.size()) {
+          add_level();
+        }
+
+        auto& values = _levels[level];
+        std::sort(values.begin(), values.end());
+
+        // An odd element out stays at this level
+        const std::size_t compacted = values.size() - values.size() % 2;
+        for (std::size_t i = _random() % 2; i < compacted; i += 2) {
+          _levels[level + 1].push_back(values[i]);
+        }
+
+        _retained -= compacted / 2;
+        values.erase(values.begin(), values.begin() + compacted);
+      }
+    }
+
+  public:
+    kll_sketch<T>(int capacity = kKllCapacity) :
+      _capacity{capacity},
+      _count{0},
+      _retained{0},
+      _max_retained{0},
+      _levels{} {
+      add_level();
+    }
+
+    void add(T const& value) {
+      _levels[0].push_back(value);
+      ++_count;
+      ++_retained;
+      compress();
+    }
+
+    void merge(kll_sketch<T> const& other) {
+      while (_levels.size() < other._levels.size()) {
+        add_level();
+      }
+
+      for (std::size_t level = 0; level < other._levels.size(); ++level) {
+        _levels[level].insert(_levels[level].end(),
+                              other._levels[level].begin(), other._levels[level].end());
+      }
+
+      _count += other._count;
+      _retained += std::accumulate(other._levels.begin(), other._levels.end(), std::size_t{0},
+                                   [] (std::size_t n, auto const& l) { return n + l.size(); });
+      compress();
+    }
+
+    // Returns the element whose rank is about q times the number of elements, 0 <= q <= 1
+    // Throws if the sketch is empty
+    T quantile(double q) const {
+      std::vector<std::pair<T, std::size_t>> weighted;
+      for (std::size_t level = 0; level < _levels.size(); ++level) {
+        for (auto const& value : _levels[level]) {
+          weighted.emplace_back(value, std::size_t{1} << level);
+        }
+      }
+
+      if (weighted.empty()) {
+        throw std::runtime_error("Empty sketch");
+      }
+
+      std::sort(weighted.begin(), weighted.end(),
+                [] (auto const& a, auto const& b) { return a.first < b.first; });
+
+      std::size_t total = 0;
+      for (auto const& w : weighted) {
+        total += w.second;
+      }
+
+      const double target = std::clamp(q, 0.0, 1.0) * total;
+      std::size_t rank = 0;
+      for (auto const& w : weighted) {
+        rank += w.second;
+        if (rank >= target) {
+          return w.first;
+        }
+      }
+
+      return weighted.back().first;
+    }
+
+    std::size_t count() const {
+      return _count;
+    }
+};
+
+// Estimates the frequency of elements with a fixed table of counters
+// Estimates never undercount, and overcount by at most about 2.7 / width
+// of the total number of elements with probability 1 - e^-depth
+template <typename T>
+class count_min_sketch
+{
+  private:
+    int _width;
+    int _depth;
+    std::vector<std::uint64_t> _counters;
+
+    std::size_t cell(std::uint64_t hash, int row) const {
+      return row * _width + mix_hash(hash + (row + 1) * 0x9e3779b97f4a7c15ULL) % _width;
+    }
+
+  public:
+    count_min_sketch<T>(int width = kCountMinWidth, int depth = kCountMinDepth) :
+      _width{width},
+      _depth{depth},
+      _counters(static_cast<std::size_t>(width) * depth, 0) {
+    }
+
+    void add(T const& value, std::uint64_t count = 1) {
+      const auto h = std::hash<T>{}(value);
+      for (int row = 0; row < _depth; ++row) {
+        _counters[cell(h, row)] += count;
+      }
+    }
+
+    // Throws if the sketches have different dimensions
+    void merge(count_min_sketch<T> const& other) {
+      if (_width != other._width || _depth != other._depth) {
+        throw std::invalid_argument("Sketches do not match");
+      }
+
+      for (std::size_t i = 0; i < _counters.size(); ++i) {
+        _counters[i] += other._counters[i];
+      }
+    }
+
+    std::uint64_t estimate(T const& value) const {
+      const auto h = std::hash<T>{}(value);
+      auto result = std::numeric_limits<std::uint64_t>::max();
+      for (int row = 0; row < _depth; ++row) {
+        result = std::min(result, _counters[cell(h, row)]);
+      }
+      return result;
+    }
+};
+
+}
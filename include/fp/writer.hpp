@@ -0,0 +1,245 @@
+/*
+
+MIT License
+
+Copyright (c) 2018 Matteo Ugolotti
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include "collections.hpp"
+
+namespace fp
+{
+
+// Default size of the buffer of a writer, in bytes
+static const std::size_t kBufferSize = 1 << 16;
+
+// Output formats supported by writer
+enum class format
+{
+  csv,    // 1,2,3
+  json,   // [1,2,3]
+  lines   // One element per line, line breaks and backslashes in strings are escaped
+};
+
+// Writes collections into a reusable buffer, converting numbers with std::to_chars,
+// and flushes the buffer to a stream or a file descriptor in large blocks.
+// The buffer is flushed when full, on flush() and on destruction.
+class writer
+{
+  private:
+    std::ostream* _stream;
+    int _fd;
+    std::size_t _capacity;
+    std::string _buffer;
+
+    // Appends a string, quoted and escaped according to the format
+    void put_string(std::string_view value, format f);
+
+    // Appends a single element
+    template <typename T>
+    void put(T const& value, format f);
+
+    void flush_if_full() {
+      if (_buffer.size() >= _capacity) {
+        flush();
+      }
+    }
+
+  public:
+    // Writer flushing to a stream
+    writer(std::ostream& stream, std::size_t capacity = kBufferSize) :
+      _stream{&stream},
+      _fd{-1},
+      _capacity{capacity} {
+      _buffer.reserve(capacity);
+    }
+
+    // Writer flushing to a file descriptor, which is not closed by the writer
+    writer(int fd, std::size_t capacity = kBufferSize) :
+      _stream{nullptr},
+      _fd{fd},
+      _capacity{capacity} {
+      _buffer.reserve(capacity);
+    }
+
+    writer(writer const&) = delete;
+    writer& operator=(writer const&) = delete;
+
+    ~writer() {
+      try {
+        flush();
+      } catch (...) {
+      }
+    }
+
+    // Writes the whole collection in the given format, followed by a newline
+    template <typename T>
+    void write(collection<T> const& c, format f);
+
+    // Writes the buffered output to the stream or file descriptor
+    // Throws if the output cannot be written
+    void flush();
+};
+
+inline void writer::flush()
+{
+  if (_stream) {
+    _stream->write(_buffer.data(), _buffer.size());
+    if (!*_stream) {
+      throw std::runtime_error("Unable to write to stream");
+    }
+  } else {
+    std::size_t written = 0;
+    while (written < _buffer.size()) {
+      const auto n = ::write(_fd, _buffer.data() + written, _buffer.size() - written);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n < 0) {
+        throw std::runtime_error("Unable to write to file descriptor");
+      }
+      written += n;
+    }
+  }
+
+  _buffer.clear();
+}
+
+inline void writer::put_string(std::string_view value, format f)
+{
+  if (f == format::json) {
+    _buffer += '"';
+    for (const char c : value) {
+      switch (c) {
+        case '"':  _buffer += "\\\""; break;
+        case '\\': _buffer += "\\\\"; break;
+        case '\n': _buffer += "\\n"; break;
+        case '\r': _buffer += "\\r"; break;
+        case '\t': _buffer += "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            static const char digits[] = "0123456789abcdef";
+            _buffer += "\\u00";
+            _buffer += digits[(c >> 4) & 0xf];
+            _buffer += digits[c & 0xf];
+          } else {
+            _buffer += c;
+          }
+      }
+    }
+    _buffer += '"';
+  } else if (f == format::csv &&
+             value.find_first_of(",\"\r\n") != std::string_view::npos) {
+    _buffer += '"';
+    for (const char c : value) {
+      if (c == '"') {
+        _buffer += '"';
+      }
+      _buffer += c;
+    }
+    _buffer += '"';
+  } else if (f == format::lines) {
+    for (const char c : value) {
+      switch (c) {
+        case '\\': _buffer += "\\\\"; break;
+        case '\n': _buffer += "\\n"; break;
+        case '\r': _buffer += "\\r"; break;
+        default:   _buffer += c;
+      }
+    }
+  } else {
+    _buffer += value;
+  }
+}
+
+template <typename T>
+void writer::put(T const& value, format f)
+{
+  if constexpr (std::is_same<T, bool>::value) {
+    _buffer += value ? "true" : "false";
+  } else if constexpr (std::is_same<T, char>::value) {
+    put_string(std::string_view{&value, 1}, f);
+  } else if constexpr (std::is_floating_point<T>::value) {
+    // JSON has no representation for NaN and infinities
+    if (f == format::json && !std::isfinite(value)) {
+      _buffer += "null";
+      return;
+    }
+    char digits[64];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    _buffer.append(digits, result.ptr);
+  } else if constexpr (std::is_arithmetic<T>::value) {
+    char digits[64];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    _buffer.append(digits, result.ptr);
+  } else if constexpr (std::is_convertible<T const&, std::string_view>::value) {
+    put_string(value, f);
+  } else {
+    std::ostringstream stream;
+    stream << value;
+    put_string(stream.str(), f);
+  }
+}
+
+template <typename T>
+void writer::write(collection<T> const& c, format f)
+{
+  const char separator = (f == format::lines) ? '\n' : ',';
+
+  if (f == format::json) {
+    _buffer += '[';
+  }
+
+  for (std::size_t i = 0; i < c._values.size(); ++i) {
+    if (i > 0) {
+      _buffer += separator;
+    }
+    put(c._values[i], f);
+    flush_if_full();
+  }
+
+  if (f == format::json) {
+    _buffer += ']';
+  }
+
+  if (f != format::lines || !c._values.empty()) {
+    _buffer += '\n';
+  }
+
+  flush_if_full();
+}
+
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../include/fp/builder.hpp"
+
+namespace fp::test {
+
+  TEST(Builder, Empty) {
+    fp::collection_builder<int> builder;
+
+    ASSERT_EQ(0, builder.build().size());
+  }
+
+  TEST(Builder, SingleProducer) {
+    fp::collection_builder<int> builder;
+    {
+      auto producer = builder.make_producer();
+      producer.append(1);
+      producer.append(2);
+      producer.append(3);
+    }
+
+    ASSERT_EQ((fp::collection<int>{ 1, 2, 3 }), builder.build());
+    ASSERT_EQ(0, builder.build().size());
+  }
+
+  TEST(Builder, ProducerKeepsOrderAcrossFlushes) {
+    fp::collection_builder<int> builder;
+    {
+      auto producer = builder.make_producer();
+      producer.append(1);
+      producer.append(2);
+      producer.flush();
+      producer.append(3);
+      producer.append(4);
+      producer.flush();
+      producer.append(5);
+    }
+
+    ASSERT_EQ((fp::collection<int>{ 1, 2, 3, 4, 5 }), builder.build());
+  }
+
+  TEST(Builder, ManyProducers) {
+    fp::collection_builder<int> builder;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&builder, t]() {
+        auto producer = builder.make_producer();
+        for (int i = 0; i < 1000; ++i) {
+          producer.append(t * 1000 + i);
+          if (i % 100 == 99) {
+            producer.flush();
+          }
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    auto values = builder.build().vector();
+    std::sort(values.begin(), values.end());
+
+    ASSERT_EQ(4000, values.size());
+    for (int i = 0; i < 4000; ++i) {
+      ASSERT_EQ(i, values[i]);
+    }
+  }
+
+}
@@ -1,3 +1,4 @@
+#include <sstream>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -50,6 +51,13 @@ namespace fp::test {
     ASSERT_EQ(v[2], c[2]);
   }
 
+  TEST(Collections, Print) {
+    std::ostringstream stream;
+    stream << fp::collection<int>{ 1, 2, 3 } << fp::collection<int>{};
+
+    ASSERT_EQ("[1,2,3][]", stream.str());
+  }
+
   TEST(Collections, Head) {
     fp::collection<char> c{ 'a', 'b', 'c' };
 
@@ -102,6 +110,58 @@ namespace fp::test {
     ASSERT_EQ(1, even);
   }
 
+  TEST(Collections, Find) {
+    fp::collection<int> c{ 1, 2, 3, 4 };
+
+    ASSERT_EQ(2, c.find([] (int n) -> bool { return n % 2 == 0; }).value());
+    ASSERT_EQ(std::nullopt, c.find([] (int n) -> bool { return n > 4; }));
+  }
+
+  TEST(Collections, Pfind) {
+    std::vector<int> v(1000);
+    for (int i = 0; i < 1000; ++i) {
+      v[i] = i;
+    }
+    fp::collection<int> c{ v };
+
+    ASSERT_EQ(251, c.pfind([] (int n) -> bool { return n > 250 && n % 2 == 1; }).value());
+    ASSERT_EQ(std::nullopt, c.pfind([] (int n) -> bool { return n < 0; }));
+  }
+
+  TEST(Collections, AnyAllNone) {
+    fp::collection<int> c{ 1, 2, 3 };
+
+    ASSERT_TRUE(c.any([] (int n) -> bool { return n == 2; }));
+    ASSERT_FALSE(c.all([] (int n) -> bool { return n == 2; }));
+    ASSERT_TRUE(c.none([] (int n) -> bool { return n > 3; }));
+  }
+
+  TEST(Collections, PanyPallPnone) {
+    std::vector<int> v(1000, 1);
+    v[600] = 2;
+    fp::collection<int> c{ v };
+
+    ASSERT_TRUE(c.pany([] (int n) -> bool { return n == 2; }));
+    ASSERT_FALSE(c.pall([] (int n) -> bool { return n == 1; }));
+    ASSERT_TRUE(c.pnone([] (int n) -> bool { return n > 2; }));
+  }
+
+  TEST(Collections, TakeWhile) {
+    fp::collection<int> c{ 1, 2, 3, 1 };
+
+    const auto t = c.take_while([] (int n) -> bool { return n < 3; });
+
+    ASSERT_EQ((fp::collection<int>{ 1, 2 }), t);
+  }
+
+  TEST(Collections, DropWhile) {
+    fp::collection<int> c{ 1, 2, 3, 1 };
+
+    const auto d = c.drop_while([] (int n) -> bool { return n < 3; });
+
+    ASSERT_EQ((fp::collection<int>{ 3, 1 }), d);
+  }
+
   TEST(Collections, Sort) {
     fp::collection<int> c{ 1, 2, 3 };
     
@@ -113,6 +173,44 @@ namespace fp::test {
     ASSERT_EQ(c[2], desc[0]);
   }
 
+  TEST(Collections, TopK) {
+    fp::collection<int> c{ 5, 1, 4, 2, 3 };
+
+    const auto top = c.top_k(3, [] (int a, int b) -> bool { return a > b; });
+
+    ASSERT_EQ((fp::collection<int>{ 5, 4, 3 }), top);
+    ASSERT_EQ(c.size(), c.top_k(10, std::less<int>()).size());
+  }
+
+  TEST(Collections, PtopK) {
+    std::vector<int> v(1000);
+    for (int i = 0; i < 1000; ++i) {
+      v[i] = (i * 7919) % 1000;
+    }
+    fp::collection<int> c{ v };
+
+    const auto top = c.ptop_k(3, [] (int a, int b) -> bool { return a > b; });
+
+    ASSERT_EQ((fp::collection<int>{ 999, 998, 997 }), top);
+  }
+
+  TEST(Collections, PartialSort) {
+    fp::collection<int> c{ 5, 1, 4, 2, 3 };
+
+    const auto sorted = c.partial_sort(2, std::less<int>());
+
+    ASSERT_EQ(c.size(), sorted.size());
+    ASSERT_EQ(1, sorted[0]);
+    ASSERT_EQ(2, sorted[1]);
+  }
+
+  TEST(Collections, Nth) {
+    fp::collection<int> c{ 5, 1, 4, 2, 3 };
+
+    ASSERT_EQ(3, c.nth(2, std::less<int>()));
+    ASSERT_THROW(c.nth(5, std::less<int>()), std::out_of_range);
+  }
+
   TEST(Collections, Map) {
     fp::collection<int> c{ 1, 2, 3 };
 
@@ -179,4 +277,60 @@ namespace fp::test {
     ASSERT_EQ(b[1], c[2]);
   }
 
+  TEST(Collections, Scan) {
+    fp::collection<int> c{ 1, 2, 3 };
+
+    const auto sums = c.scan(std::plus<int>());
+
+    ASSERT_EQ((fp::collection<int>{ 1, 3, 6 }), sums);
+  }
+
+  TEST(Collections, Pscan) {
+    std::vector<int> v(1001, 1);
+    fp::collection<int> c{ v };
+
+    const auto sums = c.pscan(std::plus<int>());
+
+    ASSERT_EQ(c.size(), sums.size());
+    for (int i = 0; i < sums.size(); ++i) {
+      ASSERT_EQ(i + 1, sums[i]);
+    }
+  }
+
+  TEST(Collections, Scanl) {
+    fp::collection<int> c{ 1, 2, 3 };
+
+    const auto res = c.scanl(std::minus<int>(), 10);
+
+    ASSERT_EQ((fp::collection<int>{ 10, 9, 7, 4 }), res);
+  }
+
+  TEST(Collections, Scanr) {
+    fp::collection<int> c{ 1, 2, 3 };
+
+    const auto res = c.scanr(std::minus<int>(), 10);
+
+    ASSERT_EQ((fp::collection<int>{ 4, 5, 7, 10 }), res);
+  }
+
+  TEST(Collections, Zip) {
+    fp::collection<int> a{ 1, 2, 3 };
+    fp::collection<char> b{ 'a', 'b' };
+
+    const auto c = a.zip(b);
+
+    ASSERT_EQ(2, c.size());
+    ASSERT_EQ(std::make_pair(1, 'a'), c[0]);
+    ASSERT_EQ(std::make_pair(2, 'b'), c[1]);
+  }
+
+  TEST(Collections, ZipWith) {
+    fp::collection<int> a{ 1, 2, 3 };
+    fp::collection<int> b{ 4, 5, 6 };
+
+    const auto c = a.zip_with(b, std::multiplies<int>());
+
+    ASSERT_EQ((fp::collection<int>{ 4, 10, 18 }), c);
+  }
+
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../include/fp/collections.hpp"
+
+namespace fp::test {
+
+  fp::collection<int> numbers(int size) {
+    std::vector<int> v(size);
+    for (int i = 0; i < size; ++i) {
+      v[i] = (i * 7919) % size;
+    }
+    return fp::collection<int>{ v };
+  }
+
+  template <typename Policy>
+  void checkPolicy(Policy const& policy) {
+    const auto c = numbers(10007);
+    const auto isEven = [] (int n) -> bool { return n % 2 == 0; };
+    const auto less = [] (int a, int b) -> bool { return a < b; };
+
+    ASSERT_EQ(c.map([] (int n) { return n * 2; }), c.map(policy, [] (int n) { return n * 2; }));
+    ASSERT_EQ(c.map(isEven), c.map(policy, isEven));
+    ASSERT_EQ(c.filter(isEven), c.filter(policy, isEven));
+    ASSERT_EQ(c.count(isEven), c.count(policy, isEven));
+    ASSERT_EQ(c.sort(less), c.sort(policy, less));
+    ASSERT_EQ(c.top_k(5, less), c.top_k(policy, 5, less));
+    ASSERT_EQ(c.partial_sort(5, less).slice(0, 5), c.partial_sort(policy, 5, less).slice(0, 5));
+    ASSERT_EQ(c.sort(less), c.partial_sort(policy, 5, less).sort(less));
+    ASSERT_EQ(c.nth(3, less), c.nth(policy, 3, less));
+    ASSERT_EQ(c.nth(9000, less), c.nth(policy, 9000, less));
+    ASSERT_EQ(c.nth(5003, less), c.nth(policy, 5003, less));
+    ASSERT_EQ(c.nth(9950, less), c.nth(policy, 9950, less));
+    ASSERT_EQ(c.reduce(std::plus<int>()), c.reduce(policy, std::plus<int>()));
+    ASSERT_EQ(c.scan(std::plus<int>()), c.scan(policy, std::plus<int>()));
+    ASSERT_EQ(c.map(isEven).scan(std::not_equal_to<bool>()), c.map(isEven).scan(policy, std::not_equal_to<bool>()));
+    ASSERT_EQ(c.find([] (int n) { return n > 5000; }), c.find(policy, [] (int n) { return n > 5000; }));
+    ASSERT_TRUE(c.any(policy, [] (int n) { return n == 10006; }));
+    ASSERT_TRUE(c.all(policy, [] (int n) { return n >= 0; }));
+    ASSERT_TRUE(c.none(policy, [] (int n) { return n < 0; }));
+    ASSERT_EQ(c.zip_with(c, std::plus<int>()), c.zip_with(policy, c, std::plus<int>()));
+    ASSERT_EQ(c.zip_with(c, std::less<int>()), c.zip_with(policy, c, std::less<int>()));
+    ASSERT_TRUE(c.zip(c) == c.zip(policy, c));
+    ASSERT_NEAR(10007, c.approx_distinct(policy), 10007 * 0.05);
+
+    int sum = 0;
+    std::mutex mutex;
+    c.each(policy, [&] (int n) { std::lock_guard<std::mutex> lock{mutex}; sum += n; });
+    ASSERT_EQ(c.reduce(std::plus<int>()), sum);
+  }
+
+  TEST(Execution, Sequenced) {
+    checkPolicy(fp::seq);
+  }
+
+  TEST(Execution, Parallel) {
+    checkPolicy(fp::par);
+    checkPolicy(fp::parallel_policy{ 3 });
+  }
+
+  TEST(Execution, ParallelUnsequenced) {
+    checkPolicy(fp::par_unseq);
+  }
+
+  TEST(Execution, Adaptive) {
+    checkPolicy(fp::adaptive);
+  }
+
+  TEST(Execution, AdaptiveSmallCollectionRunsSerially) {
+    fp::collection<int> c{ 1, 2, 3 };
+    std::set<std::thread::id> threads;
+
+    c.each(fp::adaptive, [&] (int) { threads.insert(std::this_thread::get_id()); });
+
+    ASSERT_EQ(1, threads.size());
+    ASSERT_EQ(std::this_thread::get_id(), *threads.begin());
+  }
+
+  TEST(Execution, AdaptiveExpensiveFunctionRunsInParallel) {
+    const auto c = numbers(400);
+    std::set<std::thread::id> threads;
+    std::mutex mutex;
+
+    const auto slow = [&] (int n) -> int {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        threads.insert(std::this_thread::get_id());
+      }
+      const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds{50};
+      while (std::chrono::steady_clock::now() < end) {
+      }
+      return n * 2;
+    };
+
+    const auto doubled = c.map(fp::adaptive_policy{ 4 }, slow);
+
+    ASSERT_EQ(c.map([] (int n) { return n * 2; }), doubled);
+    ASSERT_LT(1, threads.size());
+  }
+
+  TEST(Execution, AdaptiveLargeCheapWorkloadRunsInParallel) {
+    const std::size_t size = 1 << 24;
+    std::set<std::thread::id> threads;
+    std::mutex mutex;
+
+    const auto sums = fp::execute(fp::adaptive_policy{ 4 }, size, [&] (std::size_t begin, std::size_t end) {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        threads.insert(std::this_thread::get_id());
+      }
+      std::size_t sum = 0;
+      for (auto i = begin; i < end; ++i) {
+        sum += i % 7;
+      }
+      return sum;
+    });
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      expected += i % 7;
+    }
+
+    ASSERT_EQ(expected, std::accumulate(sums.begin(), sums.end(), std::size_t{0}));
+    ASSERT_LT(1, threads.size());
+  }
+
+  TEST(Execution, AdaptiveIgnoresFixedCostPerChunk) {
+    const auto c = numbers(50);
+    std::set<std::thread::id> threads;
+    std::mutex mutex;
+
+    // Same body as approx_frequency, whose partial sketch is expensive to create
+    fp::execute(fp::adaptive_policy{ 8 }, c.size(), [&] (std::size_t begin, std::size_t end) {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        threads.insert(std::this_thread::get_id());
+      }
+      fp::count_min_sketch<int> sketch;
+      for (auto i = begin; i < end; ++i) {
+        sketch.add(c[i]);
+      }
+      return sketch;
+    });
+
+    ASSERT_EQ(1, threads.size());
+    ASSERT_EQ(std::this_thread::get_id(), *threads.begin());
+    ASSERT_EQ(1, c.approx_frequency(fp::adaptive).estimate(c[0]));
+  }
+
+  TEST(Execution, NoThreads) {
+    const auto c = numbers(1000);
+
+    ASSERT_EQ(c.map([] (int n) { return n; }), c.map(fp::adaptive_policy{ 0 }, [] (int n) { return n; }));
+    ASSERT_EQ(c.map([] (int n) { return n; }), c.map(fp::parallel_policy{ 0 }, [] (int n) { return n; }));
+  }
+
+  TEST(Execution, EmptyCollection) {
+    fp::collection<int> c{};
+
+    ASSERT_EQ(0, c.map(fp::adaptive, [] (int n) { return n; }).size());
+    ASSERT_EQ(0, c.scan(fp::par, std::plus<int>()).size());
+    ASSERT_THROW(c.reduce(fp::par, std::plus<int>()), std::runtime_error);
+  }
+
+}
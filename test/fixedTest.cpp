@@ -0,0 +1,51 @@
+#include <functional>
+
+#include <gtest/gtest.h>
+#include "../include/fp/fixed.hpp"
+
+namespace fp::test {
+
+  constexpr fp::fixed_collection<int, 5> kValues{ 5, 1, 4, 2, 3 };
+
+  TEST(Fixed, Constructor) {
+    static_assert(kValues.size() == 5);
+    static_assert(kValues[0] == 5);
+    static_assert(fp::fixed_collection<int, 3>{}.size() == 0);
+
+    ASSERT_THROW((fp::fixed_collection<int, 1>{ 1, 2 }), std::length_error);
+  }
+
+  TEST(Fixed, Map) {
+    constexpr auto squares = kValues.map([] (int n) { return n * n; });
+
+    static_assert(squares == fp::fixed_collection<int, 5>{ 25, 1, 16, 4, 9 });
+  }
+
+  TEST(Fixed, Filter) {
+    constexpr auto evens = kValues.filter([] (int n) { return n % 2 == 0; });
+
+    static_assert(evens.size() == 2);
+    static_assert(evens == fp::fixed_collection<int, 5>{ 4, 2 });
+  }
+
+  TEST(Fixed, Sort) {
+    constexpr auto sorted = kValues.sort([] (int a, int b) { return a < b; });
+
+    static_assert(sorted == fp::fixed_collection<int, 5>{ 1, 2, 3, 4, 5 });
+  }
+
+  TEST(Fixed, Reduce) {
+    static_assert(kValues.reduce(std::plus<int>()) == 15);
+
+    ASSERT_THROW((fp::fixed_collection<int, 1>{}.reduce(std::plus<int>())), std::runtime_error);
+  }
+
+  TEST(Fixed, Fold) {
+    static_assert(kValues.fold(std::plus<int>(), 4) == 19);
+  }
+
+  TEST(Fixed, Collection) {
+    ASSERT_EQ((fp::collection<int>{ 5, 1, 4, 2, 3 }), kValues.collection());
+  }
+
+}
@@ -0,0 +1,95 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../include/fp/persistent.hpp"
+
+namespace fp::test {
+
+  TEST(Persistent, ConstructorEmptyCollection) {
+    fp::persistent_collection<int> c{};
+
+    ASSERT_EQ(0, c.size());
+  }
+
+  TEST(Persistent, ConstructorManyElements) {
+    fp::persistent_collection<int> c{ 1, 2, 3 };
+
+    ASSERT_EQ(3, c.size());
+    ASSERT_EQ(1, c[0]);
+    ASSERT_EQ(2, c[1]);
+    ASSERT_EQ(3, c[2]);
+  }
+
+  TEST(Persistent, ConstructFromCollection) {
+    fp::collection<int> c{ 1, 2, 3 };
+    fp::persistent_collection<int> p{ c };
+
+    ASSERT_EQ(c.vector(), p.vector());
+    ASSERT_EQ(c, p.collection());
+  }
+
+  TEST(Persistent, Head) {
+    fp::persistent_collection<char> c{ 'a', 'b', 'c' };
+
+    ASSERT_EQ('a', c.head());
+    ASSERT_THROW(fp::persistent_collection<char>{}.head(), std::runtime_error);
+  }
+
+  TEST(Persistent, Tail) {
+    fp::persistent_collection<char> c{ 'a', 'b', 'c' };
+    const auto t = c.tail();
+
+    ASSERT_EQ(c.size() - 1, t.size());
+    ASSERT_EQ(c[1], t[0]);
+    ASSERT_EQ(c[2], t[1]);
+  }
+
+  TEST(Persistent, Slice) {
+    std::vector<int> v(1000);
+    for (int i = 0; i < 1000; ++i) {
+      v[i] = i;
+    }
+    fp::persistent_collection<int> c{ v };
+
+    const auto s = c.slice(100, 900);
+
+    ASSERT_EQ(800, s.size());
+    ASSERT_EQ(100, s[0]);
+    ASSERT_EQ(899, s[799]);
+    ASSERT_THROW(c.slice(10, 1001), std::out_of_range);
+  }
+
+  TEST(Persistent, Append) {
+    fp::persistent_collection<int> c{};
+    for (int i = 0; i < 1000; ++i) {
+      c = c.append(i);
+    }
+
+    ASSERT_EQ(1000, c.size());
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ(i, c[i]);
+    }
+  }
+
+  TEST(Persistent, Concat) {
+    fp::persistent_collection<int> a{ 1 };
+    fp::persistent_collection<int> b{ 2, 3 };
+
+    const auto c = a.concat(b);
+
+    ASSERT_EQ(a.size() + b.size(), c.size());
+    ASSERT_EQ(a[0], c[0]);
+    ASSERT_EQ(b[0], c[1]);
+    ASSERT_EQ(b[1], c[2]);
+  }
+
+  TEST(Persistent, OperandsAreUnchanged) {
+    fp::persistent_collection<int> a{ 1, 2, 3 };
+
+    const auto b = a.append(4).concat(a).tail();
+
+    ASSERT_EQ((std::vector<int>{ 1, 2, 3 }), a.vector());
+    ASSERT_EQ((std::vector<int>{ 2, 3, 4, 1, 2, 3 }), b.vector());
+  }
+
+}
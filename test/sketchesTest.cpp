@@ -0,0 +1,81 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "../include/fp/collections.hpp"
+
+namespace fp::test {
+
+  TEST(Sketches, HyperLogLog) {
+    fp::hyperloglog<int> a;
+    fp::hyperloglog<int> b;
+    for (int i = 0; i < 50000; ++i) {
+      a.add(i);
+      b.add(i + 25000);
+    }
+    a.merge(b);
+
+    ASSERT_NEAR(75000, a.estimate(), 75000 * 0.05);
+  }
+
+  TEST(Sketches, KllSketch) {
+    fp::kll_sketch<int> a;
+    fp::kll_sketch<int> b;
+    for (int i = 0; i < 50000; ++i) {
+      a.add(2 * i);
+      b.add(2 * i + 1);
+    }
+    a.merge(b);
+
+    ASSERT_EQ(100000, a.count());
+    ASSERT_NEAR(50000, a.quantile(0.5), 100000 * 0.02);
+    ASSERT_NEAR(90000, a.quantile(0.9), 100000 * 0.02);
+    ASSERT_THROW(fp::kll_sketch<int>{}.quantile(0.5), std::runtime_error);
+  }
+
+  TEST(Sketches, CountMinSketch) {
+    fp::count_min_sketch<std::string> a;
+    fp::count_min_sketch<std::string> b;
+    a.add("x", 10);
+    b.add("x", 5);
+    b.add("y");
+    a.merge(b);
+
+    ASSERT_EQ(15, a.estimate("x"));
+    ASSERT_EQ(1, a.estimate("y"));
+    ASSERT_EQ(0, a.estimate("z"));
+  }
+
+  TEST(Sketches, ApproxDistinct) {
+    std::vector<int> v(100000);
+    for (int i = 0; i < v.size(); ++i) {
+      v[i] = i % 20000;
+    }
+    fp::collection<int> c{ v };
+
+    ASSERT_NEAR(20000, c.approx_distinct(), 20000 * 0.05);
+    ASSERT_NEAR(3, fp::collection<int>({ 1, 2, 3, 1 }).approx_distinct(), 0.1);
+  }
+
+  TEST(Sketches, ApproxQuantile) {
+    std::vector<int> v(100000);
+    for (int i = 0; i < v.size(); ++i) {
+      v[i] = (i * 7919) % 100000;
+    }
+    fp::collection<int> c{ v };
+
+    ASSERT_NEAR(50000, c.approx_quantile(0.5), 100000 * 0.02);
+    ASSERT_THROW(fp::collection<int>{}.approx_quantile(0.5), std::runtime_error);
+  }
+
+  TEST(Sketches, ApproxFrequency) {
+    fp::collection<int> c{ 1, 2, 2, 3, 3, 3 };
+
+    const auto frequency = c.approx_frequency();
+
+    ASSERT_EQ(1, frequency.estimate(1));
+    ASSERT_EQ(2, frequency.estimate(2));
+    ASSERT_EQ(3, frequency.estimate(3));
+  }
+
+}
@@ -0,0 +1,88 @@
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "../include/fp/writer.hpp"
+
+namespace fp::test {
+
+  TEST(Writer, Csv) {
+    std::ostringstream stream;
+    {
+      fp::writer w{ stream };
+      w.write(fp::collection<int>{ 1, -2, 3 }, fp::format::csv);
+      w.write(fp::collection<std::string>{ "a", "b,c", "d\"e" }, fp::format::csv);
+    }
+
+    ASSERT_EQ("1,-2,3\na,\"b,c\",\"d\"\"e\"\n", stream.str());
+  }
+
+  TEST(Writer, Json) {
+    std::ostringstream stream;
+    fp::writer w{ stream };
+    w.write(fp::collection<double>{ 0.5, 2 }, fp::format::json);
+    w.write(fp::collection<std::string>{ "a\"b", "c\nd" }, fp::format::json);
+    w.write(fp::collection<bool>{}, fp::format::json);
+    w.flush();
+
+    ASSERT_EQ("[0.5,2]\n[\"a\\\"b\",\"c\\nd\"]\n[]\n", stream.str());
+  }
+
+  TEST(Writer, JsonNonFinite) {
+    std::ostringstream stream;
+    fp::writer w{ stream };
+    w.write(fp::collection<double>{ 1, std::nan(""), -std::numeric_limits<double>::infinity() }, fp::format::json);
+    w.write(fp::collection<double>{ std::numeric_limits<double>::infinity() }, fp::format::csv);
+    w.flush();
+
+    ASSERT_EQ("[1,null,null]\ninf\n", stream.str());
+  }
+
+  TEST(Writer, Lines) {
+    std::ostringstream stream;
+    fp::writer w{ stream };
+    w.write(fp::collection<int>{ 10, 20, 30 }, fp::format::lines);
+
+    ASSERT_EQ("", stream.str());
+
+    w.flush();
+
+    ASSERT_EQ("10\n20\n30\n", stream.str());
+  }
+
+  TEST(Writer, LinesEscapesLineBreaks) {
+    std::ostringstream stream;
+    fp::writer w{ stream };
+    w.write(fp::collection<std::string>{ "a\nb", "c\r", "d\\e" }, fp::format::lines);
+    w.flush();
+
+    ASSERT_EQ("a\\nb\nc\\r\nd\\\\e\n", stream.str());
+  }
+
+  TEST(Writer, FlushWhenFull) {
+    std::ostringstream stream;
+    fp::writer w{ stream, 4 };
+    w.write(fp::collection<int>{ 10, 20, 30 }, fp::format::csv);
+
+    ASSERT_EQ("10,20,30\n", stream.str());
+  }
+
+  TEST(Writer, FileDescriptor) {
+    std::FILE* file = std::tmpfile();
+    {
+      fp::writer w{ fileno(file) };
+      w.write(fp::collection<char>{ 'a', 'b' }, fp::format::csv);
+    }
+
+    char content[16] = {};
+    std::rewind(file);
+    std::fread(content, 1, sizeof(content) - 1, file);
+    std::fclose(file);
+
+    ASSERT_EQ(std::string{ "a,b\n" }, content);
+  }
+
+}